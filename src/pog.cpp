@@ -18,7 +18,10 @@
 */
 #include "pog.h"
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <set>
 
 #include "btypeReader.h"
 #include "exprDesc.h"
@@ -30,111 +33,72 @@
 #include "predWriter.h"
 #include "substReader.h"
 #include "tinyxml2.h"
+#include "typeTable.h"
 
 bool isConj(const Pred& p) { return (p.getTag() == Pred::PKind::Conjunction); }
 
-BType readType(const tinyxml2::XMLElement* dom) {
-  if (dom == nullptr) throw pog::PogException("Null dom element.");
-
-  const char* tag = dom->Name();
-  if (strcmp(tag, "Id") == 0) {
-    const char* value = dom->Attribute("value");
-    if (strcmp(value, "INTEGER") == 0) {
-      return BType::INT;
-    } else if (strcmp(value, "FLOAT") == 0) {
-      return BType::FLOAT;
-    } else if (strcmp(value, "REAL") == 0) {
-      return BType::REAL;
-    } else if (strcmp(value, "STRING") == 0) {
-      return BType::STRING;
-    } else if (strcmp(value, "BOOL") == 0) {
-      return BType::BOOL;
-    } else {
-      if (dom->Attribute("suffix") != nullptr)
-        throw pog::PogException("Abstract or Concrete Set with suffix.");
-      return BType::INT;
-    }
-  } else if (strcmp(tag, "Unary_Exp") == 0) {
-    const char* op = dom->Attribute("op");
-    if (op == nullptr || strcmp(op, "POW") != 0) {
-      throw pog::PogException(
-          "Expected 'op' attribute with value 'POW' in 'Unary_Exp' tag.");
-    }
-    const tinyxml2::XMLElement* firstChild = dom->FirstChildElement();
-    if (firstChild == nullptr) {
-      throw pog::PogException("Expected child element in 'Unary_Exp' tag.");
-    }
-    return BType::POW(readType(firstChild));
-  } else if (strcmp(tag, "Binary_Exp") == 0) {
-    const char* op = dom->Attribute("op");
-    if (op == nullptr || strcmp(op, "*") != 0) {
-      throw pog::PogException(
-          "Expected 'op' attribute with value '*' in 'Binary_Exp' tag.");
-    }
-    const tinyxml2::XMLElement* fst = dom->FirstChildElement();
-    if (fst == nullptr) {
-      throw pog::PogException(
-          "Expected first child element in 'Binary_Exp' tag.");
-    }
-    const tinyxml2::XMLElement* snd = fst->NextSiblingElement();
-    if (snd == nullptr) {
-      throw pog::PogException(
-          "Expected second child element in 'Binary_Exp' tag.");
-    }
-    return BType::PROD(readType(fst), readType(snd));
-  } else if (strcmp(tag, "Struct") == 0) {
-    std::vector<std::pair<std::string, BType>> fields;
-    for (tinyxml2::XMLElement const* item =
-             dom->FirstChildElement("Record_Item");
-         item != nullptr; item = item->NextSiblingElement("Record_Item")) {
-      const char* label = item->Attribute("label");
-      if (label == nullptr) {
-        throw pog::PogException(
-            "Missing 'label' attribute in 'Record_Item' tag.");
-      }
-      const tinyxml2::XMLElement* fieldTypeElement = item->FirstChildElement();
-      if (fieldTypeElement == nullptr) {
-        throw pog::PogException("Missing child element in 'Record_Item' tag.");
-      }
-      fields.push_back({label, readType(fieldTypeElement)});
-    }
-    return BType::STRUCT(fields);
-  } else {
-    throw pog::PogException("Unexpected Tag: " + std::string(tag));
+/**
+ * @brief Tells if some Define declares a set. Only then may the types refer to
+ * abstract or enumerated sets.
+ */
+bool declaresSets(const tinyxml2::XMLElement* root) {
+  for (tinyxml2::XMLElement const* e = root->FirstChildElement("Define");
+       e != nullptr; e = e->NextSiblingElement("Define")) {
+    if (e->FirstChildElement("Set") != nullptr) return true;
   }
-  throw pog::PogException("Internal error while reading type, line " +
-                          std::to_string(dom->GetLineNum()));
+  return false;
 }
 
-void readTypeInfos(const tinyxml2::XMLElement* dom,
-                   std::vector<BType>& typeInfosOut, const char* tag = "Type") {
+/**
+ * @brief Builds the type of each type reference from the interned types,
+ * bottom-up, so that each distinct type is built once. The types may not refer
+ * to sets.
+ */
+void readTypeInfos(const pog::TypeTable& types,
+                   std::vector<BType>& typeInfosOut) {
   assert(typeInfosOut.empty());
-  if (dom != nullptr) {
-    int cpt = 0;
-    for (tinyxml2::XMLElement const* typ = dom->FirstChildElement(tag);
-         typ != nullptr; typ = typ->NextSiblingElement(tag)) {
-      bool ok = false;
-      int typref = 0;
-      const char* idAttr = typ->Attribute("id");
-      if (idAttr != nullptr) {
-        typref = std::stoi(idAttr);  // Use std::stoi for safer conversion
-        ok = true;
+  std::vector<BType> nodeTypes;
+  nodeTypes.reserve(types.size());
+  for (size_t id = 0; id < types.size(); id++) {
+    switch (types.kind(id)) {
+      case pog::TypeTable::Kind::Id: {
+        const std::string& name = types.name(id);
+        if (name == "INTEGER") {
+          nodeTypes.push_back(BType::INT);
+        } else if (name == "FLOAT") {
+          nodeTypes.push_back(BType::FLOAT);
+        } else if (name == "REAL") {
+          nodeTypes.push_back(BType::REAL);
+        } else if (name == "STRING") {
+          nodeTypes.push_back(BType::STRING);
+        } else if (name == "BOOL") {
+          nodeTypes.push_back(BType::BOOL);
+        } else {
+          throw pog::PogException("Type '" + name +
+                                  "' refers to a set that is not declared.");
+        }
+        break;
       }
-      if (!ok)
-        throw pog::PogException(
-            "Integer expected for 'id' attribute in 'Type' tag.");
-      if (typref != cpt)
-        throw pog::PogException("Unexpected typref. Expecting '" +
-                                std::to_string(cpt) + "'. Found '" +
-                                std::to_string(typref) + "'.");
-      const tinyxml2::XMLElement* typeElement = typ->FirstChildElement();
-      if (typeElement == nullptr) {  // Added null check
-        throw pog::PogException("Expected child element in 'Type' tag.");
+      case pog::TypeTable::Kind::Pow:
+        nodeTypes.push_back(BType::POW(nodeTypes[types.child(id, 0)]));
+        break;
+      case pog::TypeTable::Kind::Prod:
+        nodeTypes.push_back(BType::PROD(nodeTypes[types.child(id, 0)],
+                                        nodeTypes[types.child(id, 1)]));
+        break;
+      case pog::TypeTable::Kind::Struct: {
+        std::vector<std::pair<std::string, BType>> fields;
+        for (size_t i = 0; i < types.arity(id); i++) {
+          fields.push_back({types.label(id, i), nodeTypes[types.child(id, i)]});
+        }
+        nodeTypes.push_back(BType::STRUCT(fields));
+        break;
       }
-      typeInfosOut.push_back(readType(typeElement));
-      cpt++;
     }
   }
+  for (size_t ref : types.typeRefs()) {
+    typeInfosOut.push_back(nodeTypes[ref]);
+  }
 }
 
 pog::Set readSet(const std::vector<BType>& typeInfos,
@@ -155,7 +119,65 @@ pog::Set readSet(const std::vector<BType>& typeInfos,
   return pog::Set(Xml::VarNameFromId(id, typeInfos), vec);
 }
 
-pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
+/**
+ * @brief Accumulates the metrics of a set of predicates, measured directly on
+ * their XML elements while they are decoded.
+ */
+class MetricsBuilder {
+ public:
+  /** @brief Adds the predicate rooted at dom as a hypothesis. */
+  void addHypothesis(const tinyxml2::XMLElement* dom) {
+    measure(dom, 1);
+    m_metrics.hyps++;
+  }
+  /** @brief Adds the predicate rooted at dom as a goal. */
+  void addGoal(const tinyxml2::XMLElement* dom) { measure(dom, 1); }
+  /** @brief Adds a set declaration, which is not a hypothesis. */
+  void addSet(const tinyxml2::XMLElement* dom) { measure(dom, 1); }
+  void add(const MetricsBuilder& other) {
+    m_metrics.nodes += other.m_metrics.nodes;
+    m_metrics.depth = std::max(m_metrics.depth, other.m_metrics.depth);
+    m_metrics.hyps += other.m_metrics.hyps;
+    m_types.insert(other.m_types.begin(), other.m_types.end());
+  }
+  pog::Metrics metrics() const {
+    pog::Metrics res = m_metrics;
+    res.types = m_types.size();
+    return res;
+  }
+  /**
+   * @brief Metrics of base and this builder together, without copying the
+   * types of base.
+   */
+  pog::Metrics metrics(const MetricsBuilder& base) const {
+    pog::Metrics res = base.m_metrics;
+    res.nodes += m_metrics.nodes;
+    res.depth = std::max(res.depth, m_metrics.depth);
+    res.hyps += m_metrics.hyps;
+    res.types = base.m_types.size();
+    for (int typref : m_types) {
+      if (base.m_types.count(typref) == 0) res.types++;
+    }
+    return res;
+  }
+
+ private:
+  void measure(const tinyxml2::XMLElement* dom, size_t level) {
+    m_metrics.nodes++;
+    m_metrics.depth = std::max(m_metrics.depth, level);
+    int typref;
+    if (dom->QueryIntAttribute("typref", &typref) == tinyxml2::XML_SUCCESS)
+      m_types.insert(typref);
+    for (tinyxml2::XMLElement const* ch = dom->FirstChildElement();
+         ch != nullptr; ch = ch->NextSiblingElement()) {
+      measure(ch, level + 1);
+    }
+  }
+  pog::Metrics m_metrics;
+  std::set<int> m_types;
+};
+
+pog::pog pog::read(tinyxml2::XMLDocument& pogDoc, bool withMetrics) {
   pog res;
   auto root = pogDoc.RootElement();
   if (root == nullptr)
@@ -169,10 +191,18 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
     typeInfosElement = root->FirstChildElement("TypeInfos");
     if (typeInfosElement == nullptr)
       throw PogException("TypeInfos or RichTypesInfo element expected.");
-    Xml::readTypeInfos(typeInfosElement, res.typeInfos);
+    // Set types are built by BAST; the other types through a TypeTable
+    if (declaresSets(root)) {
+      Xml::readTypeInfos(typeInfosElement, res.typeInfos);
+    } else {
+      TypeTable types;
+      types.readTypeInfos(typeInfosElement);
+      readTypeInfos(types, res.typeInfos);
+    }
   }
 
   // Defines
+  std::map<std::string, MetricsBuilder> defineMetrics;
   for (tinyxml2::XMLElement const* e = root->FirstChildElement("Define");
        e != nullptr; e = e->NextSiblingElement("Define")) {
     const char* nameAttr = e->Attribute("name");
@@ -185,17 +215,21 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       hash = std::stoul(hashAttr, nullptr, 0);
     }
     auto def = Define(nameAttr, hash);
+    MetricsBuilder metrics;
     for (tinyxml2::XMLElement const* ch = e->FirstChildElement(); ch != nullptr;
          ch = ch->NextSiblingElement()) {
       if (strcmp(ch->Name(), "Set") == 0) {
+        if (withMetrics) metrics.addSet(ch);
         Set s = readSet(res.typeInfos, ch);
         def.contents.push_back(std::move(s));
       } else {
+        if (withMetrics) metrics.addHypothesis(ch);
         Pred p = Xml::readPredicate(ch, res.typeInfos);
         assert(!isConj(p));
         def.contents.push_back(std::move(p));
       }
     }
+    if (withMetrics) defineMetrics[nameAttr] = metrics;
     res.defines.push_back(std::move(def));
   }
   // Proof_Obligation
@@ -215,6 +249,8 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       const char* tagText = tagElement->GetText();
       if (tagText) tagStr = tagText;  // GetText() can return nullptr
     }
+    // Metrics of the hypotheses common to all simple goals
+    MetricsBuilder commonMetrics;
     // Definitions
     std::vector<std::string> definitions;
     for (tinyxml2::XMLElement const* e = po->FirstChildElement("Definition");
@@ -223,6 +259,10 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       if (!defNameAttr)
         throw PogException("Attribute 'name' expected in 'Definition' tag.");
       definitions.push_back(defNameAttr);
+      if (withMetrics) {
+        auto it = defineMetrics.find(defNameAttr);
+        if (it != defineMetrics.end()) commonMetrics.add(it->second);
+      }
     }
     // Hypothesis
     std::vector<Pred> hyps;
@@ -235,9 +275,11 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       Pred p = Xml::readPredicate(predElement, res.typeInfos);
       assert(!isConj(p));
       hyps.push_back(std::move(p));
+      if (withMetrics) commonMetrics.addHypothesis(predElement);
     }
     // Local Hypotheses
     std::vector<Pred> localHyps;
+    std::vector<MetricsBuilder> localHypsMetrics;
     for (tinyxml2::XMLElement const* e = po->FirstChildElement("Local_Hyp");
          e != nullptr; e = e->NextSiblingElement("Local_Hyp")) {
       const tinyxml2::XMLElement* predElement = e->FirstChildElement();
@@ -246,6 +288,16 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       Pred p = Xml::readPredicate(predElement, res.typeInfos);
       assert(!isConj(p));
       localHyps.push_back(std::move(p));
+      if (withMetrics) {
+        localHypsMetrics.emplace_back();
+        localHypsMetrics.back().addHypothesis(predElement);
+      }
+    }
+    // Metrics of the whole group
+    MetricsBuilder groupMetrics;
+    if (withMetrics) {
+      groupMetrics.add(commonMetrics);
+      for (const auto& m : localHypsMetrics) groupMetrics.add(m);
     }
     // Simple Goal
     std::vector<PO> simpleGoals;
@@ -292,19 +344,52 @@ pog::pog pog::read(tinyxml2::XMLDocument& pogDoc) {
       }
 
       Pred _goal = Xml::readPredicate(predElementGoal, res.typeInfos);
-      simpleGoals.push_back({_tag, _localHypRefs, std::move(_goal)});
+      Metrics _metrics;
+      if (withMetrics) {
+        MetricsBuilder goalOnly;
+        goalOnly.addGoal(predElementGoal);
+        groupMetrics.add(goalOnly);
+        // the common hypotheses are merged in by metrics(commonMetrics)
+        MetricsBuilder goalMetrics;
+        // Ref_Hyp numbers the local hypotheses from 1
+        for (int ref : _localHypRefs) {
+          if (1 <= ref && static_cast<size_t>(ref) <= localHypsMetrics.size())
+            goalMetrics.add(localHypsMetrics[ref - 1]);
+        }
+        goalMetrics.add(goalOnly);
+        _metrics = goalMetrics.metrics(commonMetrics);
+      }
+      simpleGoals.push_back({_tag, _localHypRefs, std::move(_goal), _metrics});
     }
-    res.pos.push_back(POGroup(tagStr, goalHash, definitions, std::move(hyps),
-                              std::move(localHyps), std::move(simpleGoals)));
+    POGroup group(tagStr, goalHash, definitions, std::move(hyps),
+                  std::move(localHyps), std::move(simpleGoals));
+    group.metrics = groupMetrics.metrics();
+    res.pos.push_back(std::move(group));
   }
   return res;
 }
 
-pog::pog pog::read(const std::filesystem::path& pogFile) {
+pog::pog pog::read(const std::filesystem::path& pogFile, bool withMetrics) {
   tinyxml2::XMLDocument doc;
   if (doc.LoadFile(pogFile.string().c_str()) != tinyxml2::XML_SUCCESS)
     throw PogException("Failed to load file: " + pogFile.string());
-  return read(doc);
+  return read(doc, withMetrics);
+}
+
+std::vector<std::pair<size_t, size_t>> pog::pog::byDecreasingCost() const {
+  std::vector<std::pair<size_t, size_t>> res;
+  for (size_t i = 0; i < pos.size(); i++) {
+    for (size_t j = 0; j < pos[i].simpleGoals.size(); j++) {
+      res.push_back({i, j});
+    }
+  }
+  std::stable_sort(res.begin(), res.end(),
+                   [this](const std::pair<size_t, size_t>& a,
+                          const std::pair<size_t, size_t>& b) {
+                     return pos[a.first].simpleGoals[a.second].metrics.cost() >
+                            pos[b.first].simpleGoals[b.second].metrics.cost();
+                   });
+  return res;
 }
 
 void pog::pog::accept(pogVisitor& v) const { v.visitPog(*this); }
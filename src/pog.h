@@ -23,6 +23,7 @@
 #include <variant>
 using std::variant;
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gpred.h"
@@ -40,6 +41,7 @@ class PO;
 class POGroup;
 class Set;
 class Define;
+class Metrics;
 
 class pogVisitor;
 
@@ -49,10 +51,32 @@ class pogVisitor;
  *
  * @param pog Reference to a tinyxml2::XMLDocument object containing the POG
  * data.
+ * @param withMetrics When true, the size metrics of each PO and POGroup are
+ * computed while the predicates are decoded (see Metrics).
  * @return Pog The Pog instance containing the data in the read POG file.
  */
-pog read(tinyxml2::XMLDocument &pog);
-pog read(const std::filesystem::path &filename);
+pog read(tinyxml2::XMLDocument &pog, bool withMetrics = false);
+pog read(const std::filesystem::path &filename, bool withMetrics = false);
+
+/**
+ * @brief Cheap size metrics of a proof obligation, used to estimate its cost
+ *
+ * The metrics are measured on the XML elements of the predicates given to the
+ * prover, i.e. the goal and the hypotheses resolved through the definitions,
+ * the common hypotheses and the referenced local hypotheses.
+ * They are only computed when requested from pog::read; otherwise all fields
+ * are zero.
+ */
+class Metrics {
+ public:
+  size_t nodes = 0;  // number of predicate and expression nodes
+  size_t depth = 0;  // maximal depth of a predicate
+  size_t hyps = 0;   // number of resolved hypotheses
+  size_t types = 0;  // number of distinct types used
+
+  /** @brief Estimated proof cost: the size of the prover input. */
+  size_t cost() const { return nodes + hyps; }
+};
 
 /**
  * @brief Represents the proof obligations of a B component
@@ -69,6 +93,15 @@ class pog {
   std::vector<POGroup> pos;
   std::vector<BType> typeInfos;
 
+  /**
+   * @brief Lists the simple goals by decreasing estimated cost.
+   *
+   * @return pairs (index in pos, index in simpleGoals). Goals with the same
+   * cost, e.g. all goals when metrics were not computed, are kept in document
+   * order.
+   */
+  std::vector<std::pair<size_t, size_t>> byDecreasingCost() const;
+
   void accept(pogVisitor &v) const;
 };
 
@@ -95,6 +128,7 @@ class POGroup {
   std::vector<Pred>
       localHyps;  // chaque element d'une conjonction est stocké séparement
   std::vector<PO> simpleGoals;
+  Metrics metrics;  // covers all the hypotheses and all the simple goals
   POGroup(const std::string &tag, size_t goalHash,
           const std::vector<std::string> &definitions, std::vector<Pred> &&hyps,
           std::vector<Pred> &&localHyps, std::vector<PO> &&simpleGoals)
@@ -116,9 +150,14 @@ class PO {
   std::string tag;
   std::vector<int> localHypsRef;
   Pred goal;
-  PO(const std::string &tag, const std::vector<int> &localHypsRef, Pred &&goal)
-      : tag{tag}, localHypsRef{localHypsRef}, goal{std::move(goal)} {}
-  PO copy() const { return PO(tag, localHypsRef, goal.copy()); }
+  Metrics metrics;
+  PO(const std::string &tag, const std::vector<int> &localHypsRef, Pred &&goal,
+     const Metrics &metrics = Metrics())
+      : tag{tag},
+        localHypsRef{localHypsRef},
+        goal{std::move(goal)},
+        metrics{metrics} {}
+  PO copy() const { return PO(tag, localHypsRef, goal.copy(), metrics); }
 
   void accept(pogVisitor &v) const;
 };
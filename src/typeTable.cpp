@@ -0,0 +1,146 @@
+/** typeTable.cpp
+
+   \copyright Copyright © CLEARSY 2025
+   \license This file is part of POGLIB.
+
+   POGLIB is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+    POGLIB is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with POGLIB. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "typeTable.h"
+
+#include <cstring>
+#include <functional>
+
+#include "pog.h"
+#include "tinyxml2.h"
+
+static void hashCombine(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void pog::TypeTable::readTypeInfos(const tinyxml2::XMLElement* dom) {
+  if (dom == nullptr) return;
+  size_t cpt = m_typeRefs.size();
+  for (tinyxml2::XMLElement const* typ = dom->FirstChildElement("Type");
+       typ != nullptr; typ = typ->NextSiblingElement("Type")) {
+    int typref;
+    if (typ->QueryIntAttribute("id", &typref) != tinyxml2::XML_SUCCESS)
+      throw PogException("Integer expected for 'id' attribute in 'Type' tag.");
+    if (typref < 0 || static_cast<size_t>(typref) != cpt)
+      throw PogException("Unexpected typref. Expecting '" +
+                         std::to_string(cpt) + "'. Found '" +
+                         std::to_string(typref) + "'.");
+    const tinyxml2::XMLElement* typeElement = typ->FirstChildElement();
+    if (typeElement == nullptr)
+      throw PogException("Expected child element in 'Type' tag.");
+    m_typeRefs.push_back(read(typeElement));
+    cpt++;
+  }
+}
+
+size_t pog::TypeTable::read(const tinyxml2::XMLElement* dom) {
+  if (dom == nullptr) throw PogException("Null dom element.");
+
+  const char* tag = dom->Name();
+  if (strcmp(tag, "Id") == 0) {
+    const char* value = dom->Attribute("value");
+    if (value == nullptr)
+      throw PogException("Missing 'value' attribute in 'Id' tag.");
+    std::string name = value;
+    const char* suffix = dom->Attribute("suffix");
+    if (suffix != nullptr) name = name + "$" + suffix;
+    return intern(Kind::Id, name, {}, {});
+  } else if (strcmp(tag, "Unary_Exp") == 0) {
+    const char* op = dom->Attribute("op");
+    if (op == nullptr || strcmp(op, "POW") != 0) {
+      throw PogException(
+          "Expected 'op' attribute with value 'POW' in 'Unary_Exp' tag.");
+    }
+    const tinyxml2::XMLElement* firstChild = dom->FirstChildElement();
+    if (firstChild == nullptr) {
+      throw PogException("Expected child element in 'Unary_Exp' tag.");
+    }
+    return intern(Kind::Pow, {}, {read(firstChild)}, {});
+  } else if (strcmp(tag, "Binary_Exp") == 0) {
+    const char* op = dom->Attribute("op");
+    if (op == nullptr || strcmp(op, "*") != 0) {
+      throw PogException(
+          "Expected 'op' attribute with value '*' in 'Binary_Exp' tag.");
+    }
+    const tinyxml2::XMLElement* fst = dom->FirstChildElement();
+    if (fst == nullptr) {
+      throw PogException("Expected first child element in 'Binary_Exp' tag.");
+    }
+    const tinyxml2::XMLElement* snd = fst->NextSiblingElement();
+    if (snd == nullptr) {
+      throw PogException("Expected second child element in 'Binary_Exp' tag.");
+    }
+    const size_t lhs = read(fst);
+    const size_t rhs = read(snd);
+    return intern(Kind::Prod, {}, {lhs, rhs}, {});
+  } else if (strcmp(tag, "Struct") == 0) {
+    std::vector<size_t> fields;
+    std::vector<std::string> labels;
+    for (tinyxml2::XMLElement const* item =
+             dom->FirstChildElement("Record_Item");
+         item != nullptr; item = item->NextSiblingElement("Record_Item")) {
+      const char* label = item->Attribute("label");
+      if (label == nullptr) {
+        throw PogException("Missing 'label' attribute in 'Record_Item' tag.");
+      }
+      const tinyxml2::XMLElement* fieldTypeElement = item->FirstChildElement();
+      if (fieldTypeElement == nullptr) {
+        throw PogException("Missing child element in 'Record_Item' tag.");
+      }
+      fields.push_back(read(fieldTypeElement));
+      labels.push_back(label);
+    }
+    return intern(Kind::Struct, {}, fields, labels);
+  }
+  throw PogException("Unexpected Tag: " + std::string(tag));
+}
+
+size_t pog::TypeTable::intern(Kind kind, const std::string& name,
+                              const std::vector<size_t>& children,
+                              const std::vector<std::string>& labels) {
+  // sub-types are already interned: their indices identify them
+  size_t hash = static_cast<size_t>(kind);
+  hashCombine(hash, std::hash<std::string>{}(name));
+  for (size_t i = 0; i < children.size(); i++) {
+    hashCombine(hash, children[i]);
+    if (!labels.empty()) hashCombine(hash, std::hash<std::string>{}(labels[i]));
+  }
+
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Node& node = m_nodes[it->second];
+    if (node.kind != kind || node.name != name ||
+        node.count != children.size())
+      continue;
+    bool same = true;
+    for (size_t i = 0; same && i < children.size(); i++) {
+      same = m_children[node.first + i] == children[i] &&
+             m_labels[node.first + i] == (labels.empty() ? "" : labels[i]);
+    }
+    if (same) return it->second;
+  }
+
+  const size_t id = m_nodes.size();
+  m_nodes.push_back({kind, name, m_children.size(), children.size()});
+  for (size_t i = 0; i < children.size(); i++) {
+    m_children.push_back(children[i]);
+    m_labels.push_back(labels.empty() ? std::string() : labels[i]);
+  }
+  m_index.emplace(hash, id);
+  return id;
+}
@@ -0,0 +1,102 @@
+/** typeTable.h
+
+   \copyright Copyright © CLEARSY 2025
+   \license This file is part of POGLIB.
+
+   POGLIB is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+    POGLIB is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with POGLIB. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef TYPETABLE_H
+#define TYPETABLE_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tinyxml2 {
+class XMLElement;
+}  // namespace tinyxml2
+
+namespace pog {
+
+/**
+ * @brief Flat table of interned types
+ *
+ * All the types are stored as nodes in one contiguous array. A node refers to
+ * its sub-types by their index in the table, and structurally equal types are
+ * stored only once: two types are equal if and only if they have the same
+ * index. Each node is hashed once, when it is interned, so that the lookup of
+ * a type is a hashed lookup followed by a shallow comparison.
+ *
+ * The table also records, for each type reference (the 'typref' attribute in
+ * POG files), the index of the corresponding node. A node is always added
+ * after its sub-types, so the nodes can be processed bottom-up in index order.
+ */
+class TypeTable {
+ public:
+  enum class Kind { Id, Pow, Prod, Struct };
+
+  /** @brief Reads all the 'Type' children of a 'TypeInfos' element. */
+  void readTypeInfos(const tinyxml2::XMLElement *dom);
+
+  /**
+   * @brief Reads a type element and interns it.
+   * @return the index of the node representing the type.
+   */
+  size_t read(const tinyxml2::XMLElement *dom);
+
+  /** @brief Number of distinct types. */
+  size_t size() const { return m_nodes.size(); }
+
+  /** @brief Node index of each type reference, in document order. */
+  const std::vector<size_t> &typeRefs() const { return m_typeRefs; }
+
+  Kind kind(size_t id) const { return m_nodes.at(id).kind; }
+  /**
+   * @brief Name of an Id node, empty for the other kinds. A suffix, if any,
+   * is appended after a '$'.
+   */
+  const std::string &name(size_t id) const { return m_nodes.at(id).name; }
+  size_t arity(size_t id) const { return m_nodes.at(id).count; }
+  /** @brief Node index of the i-th sub-type (or field) of a node. */
+  size_t child(size_t id, size_t i) const {
+    return m_children.at(m_nodes.at(id).first + i);
+  }
+  /** @brief Label of the i-th field of a Struct node. */
+  const std::string &label(size_t id, size_t i) const {
+    return m_labels.at(m_nodes.at(id).first + i);
+  }
+
+ private:
+  struct Node {
+    Kind kind;
+    std::string name;
+    size_t first;  // position of the first sub-type in m_children
+    size_t count;  // number of sub-types
+  };
+
+  size_t intern(Kind kind, const std::string &name,
+                const std::vector<size_t> &children,
+                const std::vector<std::string> &labels);
+
+  std::vector<Node> m_nodes;
+  std::vector<size_t> m_children;
+  std::vector<std::string> m_labels;  // field labels, parallel to m_children
+  std::unordered_multimap<size_t, size_t> m_index;  // hash -> node index
+  std::vector<size_t> m_typeRefs;
+};
+
+}  // namespace pog
+
+#endif  // TYPETABLE_H
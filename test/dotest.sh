@@ -20,7 +20,12 @@ outdir="$testdir/output/result/$id"
 rm -rf "$outdir"
 mkdir -p "$outdir"
 
-$program "$inpdir/input.pog" > "$outdir/output.pog" 2> "$outdir/stderr"
+args=""
+if [ -f "$inpdir/args" ]; then
+    args=$(cat "$inpdir/args")
+fi
+
+$program $args "$inpdir/input.pog" > "$outdir/output.pog" 2> "$outdir/stderr"
 echo $? > "$outdir/exitcode"
 
 error=0
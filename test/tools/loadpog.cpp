@@ -25,13 +25,20 @@
 #include <iostream>
 #include <string>
 
+static void printMetrics(const pog::Metrics &m) {
+  std::cout << "nodes=" << m.nodes << " depth=" << m.depth
+            << " hyps=" << m.hyps << " types=" << m.types
+            << " cost=" << m.cost() << std::endl;
+}
+
 int main(int argc, char **argv) {
-  if (argc != 2) {
-    std::cerr << "Usage: loadpog <pog_file>" << std::endl;
+  bool metrics = argc == 3 && std::string(argv[1]) == "-m";
+  if (argc != 2 && !metrics) {
+    std::cerr << "Usage: loadpog [-m] <pog_file>" << std::endl;
     return 1;
   }
 
-  std::string pog_file = argv[1];
+  std::string pog_file = argv[argc - 1];
 
   std::filesystem::path pog_path(pog_file);
   if (!std::filesystem::exists(pog_path)) {
@@ -41,7 +48,7 @@ int main(int argc, char **argv) {
 
   pog::pog pog;
   try {
-    pog = pog::read(pog_path);
+    pog = pog::read(pog_path, metrics);
   } catch (const pog::PogException &e) {
     std::cerr << "POGLIB error: " << e.what() << std::endl;
     return 1;
@@ -49,6 +56,18 @@ int main(int argc, char **argv) {
     std::cerr << "Error: " << e.what() << std::endl;
     return 1;
   }
+  if (metrics) {
+    for (size_t i = 0; i < pog.pos.size(); i++) {
+      std::cout << "Group " << i << " " << pog.pos[i].tag << ": ";
+      printMetrics(pog.pos[i].metrics);
+    }
+    for (const auto &[group, goal] : pog.byDecreasingCost()) {
+      const auto &po = pog.pos[group].simpleGoals[goal];
+      std::cout << "PO " << group << "." << goal << " " << po.tag << ": ";
+      printMetrics(po.metrics);
+    }
+    return 0;
+  }
   tinyxml2::XMLPrinter printer(stdout);
   Xml::pogXmlWriter writer(&printer);
   pog.accept(writer);